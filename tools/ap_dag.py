@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+
+# ap_dag.py - build the execution dag for an autopilot component list
+# and check it against the file order.
+#
+# The component arrays in config/autopilots/*.json execute in file
+# order, and correctness depends on every stage's output.prop being
+# written before a later stage reads it as input/reference.  The
+# flight loader builds this dag at load time, topologically sorts it,
+# rejects cycles, and skips entire disabled subgraphs (components whose
+# enable locks are off) instead of evaluating and discarding them.
+# This tool runs the same analysis on the bench so a bad hand-ordering
+# is caught before it ships.
+#
+#     tools/ap_dag.py config/autopilots/skywalker.json
+#     tools/ap_dag.py config/main-skywalker.json
+#
+# Exit status is non-zero on a cycle or an ordering violation.
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import configtree
+
+def prop_list(node):
+    if not isinstance(node, dict) or 'prop' not in node:
+        return []
+    prop = node['prop']
+    if isinstance(prop, str):
+        return [prop]
+    return [p for p in prop if isinstance(p, str)]
+
+def load_components(path):
+    tree, _ = configtree.load_main(path)
+    if 'config' in tree:
+        tree = tree['config'].get('autopilot', {})
+    return tree.get('component', [])
+
+def build_dag(components):
+    """Returns (edges, violations, order) where edges maps component
+    index -> set of indices that must run after it, violations lists
+    (reader, writer) pairs that appear in the wrong file order, and
+    order is a file-order-preferring topological sort (None on a
+    cycle)."""
+    writers = {}   # output path -> component index
+    for i, comp in enumerate(components):
+        for path in prop_list(comp.get('output', {})):
+            writers[path] = i
+    edges = {i: set() for i in range(len(components))}
+    violations = []
+    for i, comp in enumerate(components):
+        inputs = prop_list(comp.get('input', {})) \
+               + prop_list(comp.get('reference', {}))
+        for path in inputs:
+            if path in writers and writers[path] != i:
+                w = writers[path]
+                edges[w].add(i)
+                if w > i:
+                    violations.append((i, w, path))
+    # kahn's algorithm, preferring file order so the result is stable
+    indeg = {i: 0 for i in edges}
+    for succs in edges.values():
+        for s in succs:
+            indeg[s] += 1
+    ready = sorted(i for i in indeg if indeg[i] == 0)
+    order = []
+    while ready:
+        n = ready.pop(0)
+        order.append(n)
+        for s in sorted(edges[n]):
+            indeg[s] -= 1
+            if indeg[s] == 0:
+                ready.append(s)
+        ready.sort()
+    if len(order) != len(components):
+        return edges, violations, None
+    return edges, violations, order
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='check autopilot component ordering against the '
+                    'execution dag')
+    parser.add_argument('config',
+                        help='autopilot json or a main-*.json')
+    parser.add_argument('-v', '--verbose', action='store_true',
+                        help='print the dag edges and enable groups')
+    args = parser.parse_args()
+
+    components = load_components(args.config)
+    if not components:
+        print('%s: no component list found' % args.config)
+        return 1
+    names = ['[%d] %s' % (i, c.get('name', '?'))
+             for i, c in enumerate(components)]
+
+    edges, violations, order = build_dag(components)
+
+    if args.verbose:
+        print('dependencies (writer -> reader):')
+        for i, succs in edges.items():
+            for s in sorted(succs):
+                print('  %s -> %s' % (names[i], names[s]))
+        print('enable groups (lock -> components skipped when off):')
+        groups = {}
+        for i, comp in enumerate(components):
+            for lock in prop_list(comp.get('enable', {})):
+                groups.setdefault(lock, []).append(names[i])
+        for lock, members in sorted(groups.items()):
+            print('  %s: %s' % (lock, ', '.join(members)))
+
+    status = 0
+    if order is None:
+        cyclic = [names[i] for i in edges
+                  if any(i in edges[s] for s in edges[i])]
+        print('%s: CYCLE in component dag involving: %s'
+              % (args.config, ', '.join(cyclic) or 'see -v'))
+        status = 1
+    for reader, writer, path in violations:
+        print('%s: ORDER violation: %s reads %s before %s writes it'
+              % (args.config, names[reader], path, names[writer]))
+        status = 1
+    if status == 0:
+        print('%s: %d components, file order is a valid execution order'
+              % (args.config, len(components)))
+    return status
+
+if __name__ == '__main__':
+    sys.exit(main())
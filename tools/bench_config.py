@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+
+# bench_config.py - regression benchmark for the config system.
+#
+# Loads every config/main-*.json and reports, per main: json parse
+# time, include resolution time, schema apply (flatten) time, resolved
+# property-tree node count, and approximate tree memory.  Then models a
+# synthetic n-frame run from the configured workload: autopilot
+# component evaluations, mission task activations, and comms channel
+# sends per frame (hz schedules when present, legacy skips otherwise).
+#
+# This is the gate to run before and after any config-system
+# performance change; keep the output diffable.
+#
+#     tools/bench_config.py [--frames 10000] [--strict] [config-dir]
+
+import argparse
+import glob
+import json
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import configtree
+import schema as schema_mod
+from config_compile import flatten
+
+def tree_bytes(node):
+    """Rough resident size of the parsed tree."""
+    if isinstance(node, dict):
+        return 64 + sum(len(k) + tree_bytes(v) for k, v in node.items())
+    if isinstance(node, list):
+        return 56 + sum(tree_bytes(v) for v in node)
+    if isinstance(node, str):
+        return 49 + len(node)
+    return 28
+
+def count_components(tree):
+    ap = tree.get('config', {}).get('autopilot', {})
+    return len(ap.get('component', []))
+
+def count_tasks(tree):
+    mission = tree.get('config', {}).get('mission', {})
+    n = 0
+    for group in ('global_tasks', 'sequential_tasks', 'standby_tasks'):
+        task = mission.get(group, {}).get('task', [])
+        n += len(task) if isinstance(task, list) else 1
+    return n
+
+def channel_sends_per_frame(section, loop_hz):
+    """Messages per frame for one comms section: hz schedule when
+    present, legacy *_skip counts otherwise."""
+    if not isinstance(section, dict):
+        return 0.0
+    sends = 0.0
+    schedule = section.get('schedule')
+    if isinstance(schedule, dict):
+        for key, hz in schedule.items():
+            if key.endswith('_hz'):
+                sends += float(hz) / loop_hz
+    else:
+        for key, skip in section.items():
+            if key.endswith('_skip'):
+                sends += 1.0 / (int(str(skip)) + 1)
+    return sends
+
+def bench_main(path, sch, frames, loop_hz):
+    t0 = time.perf_counter()
+    loader = configtree.ConfigLoader()
+    tree, input_files = loader.load_main(path)
+    t1 = time.perf_counter()
+    records = []
+    flatten(tree, '', records, sch)
+    t2 = time.perf_counter()
+
+    config = tree.get('config', {})
+    per_frame = {
+        'components': count_components(tree),
+        'tasks': count_tasks(tree),
+        'log_msgs': channel_sends_per_frame(config.get('logging', {}),
+                                            loop_hz),
+        'link_msgs': channel_sends_per_frame(
+            config.get('remote_link', {}), loop_hz),
+    }
+    return {
+        'files': len(input_files),
+        'nodes': len(records),
+        'bytes': tree_bytes(tree),
+        'load_ms': (t1 - t0) * 1e3,
+        'flatten_ms': (t2 - t1) * 1e3,
+        'per_frame': per_frame,
+        'frame_msgs': frames * (per_frame['log_msgs']
+                                + per_frame['link_msgs']),
+    }
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='benchmark config load and configured frame cost')
+    parser.add_argument('config_dir', nargs='?', default='config')
+    parser.add_argument('--frames', type=int, default=10000,
+                        help='synthetic run length (default 10000)')
+    parser.add_argument('--loop-hz', type=float, default=100.0)
+    parser.add_argument('--strict', action='store_true',
+                        help='exit non-zero if any main fails to load')
+    args = parser.parse_args()
+
+    sch, _ = schema_mod.load(os.path.join(args.config_dir, 'schema',
+                                          'types.json'))
+    mains = sorted(glob.glob(os.path.join(args.config_dir,
+                                          'main-*.json')))
+    failures = 0
+    print('%-28s %5s %6s %8s %8s %9s  %s'
+          % ('main', 'files', 'nodes', 'kbytes', 'load_ms',
+             'flat_ms', 'per-frame (comp/task/log/link)'))
+    for path in mains:
+        name = os.path.basename(path)
+        try:
+            r = bench_main(path, sch, args.frames, args.loop_hz)
+        except (OSError, ValueError, schema_mod.SchemaError) as e:
+            print('%-28s LOAD FAILED: %s' % (name, e))
+            failures += 1
+            continue
+        pf = r['per_frame']
+        print('%-28s %5d %6d %8.1f %8.2f %9.2f  %d/%d/%.2f/%.2f'
+              % (name, r['files'], r['nodes'], r['bytes'] / 1024.0,
+                 r['load_ms'], r['flatten_ms'], pf['components'],
+                 pf['tasks'], pf['log_msgs'], pf['link_msgs']))
+    if failures:
+        print('%d main(s) failed to load' % failures)
+        if args.strict:
+            return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+
+# config_compile.py - flatten a main-*.json config (and its transitive
+# include chain) into a single memory-mappable binary blob.
+#
+# The JSON tree remains the source of truth; the blob is a build
+# artifact.  The flight code can mmap the blob at boot and walk the
+# pre-resolved node table directly instead of re-parsing a dozen JSON
+# files.  The blob records a sha256 over all of the input files (in
+# include order) so a stale blob is detected and never trusted.
+#
+# Blob layout (all integers little endian):
+#
+#   offset  size  field
+#        0     4  magic "RCFB"
+#        4     2  format version (currently 2)
+#        6     2  flags (reserved, 0)
+#        8     4  node count
+#       12     4  string pool length (bytes)
+#       16     4  prop path count
+#       20     4  reserved (0)
+#       24    32  sha256 of input files, in include order
+#       56   16*n node records
+#        .   4*p  prop path table (u32 string pool offsets)
+#        .     .  string pool (NUL terminated utf-8 strings)
+#
+# The prop path table lists every property path referenced by a
+# component/task wiring field ('prop' entries under input, output,
+# reference, enable, ...).  The runtime interns these into direct node
+# handles at load time and reports any path that fails to bind, so the
+# control loop never resolves a string path per frame.
+#
+# Node record (16 bytes):
+#
+#   u32 path offset (into string pool)
+#   u32 type: 0=string, 1=double, 2=bool, 3=int
+#   u64 value: string -> u32 offset + u32 len, double -> f64,
+#              bool/int -> i64
+#
+# Records are sorted by path so the runtime can binary search without
+# building any auxiliary index.
+
+import argparse
+import hashlib
+import os
+import struct
+import sys
+
+import configtree
+import schema as schema_mod
+
+MAGIC = b"RCFB"
+VERSION = 2
+HEADER_LEN = 56
+
+TYPE_STRING = 0
+TYPE_DOUBLE = 1
+TYPE_BOOL = 2
+TYPE_INT = 3
+
+def flatten(node, path, records, sch=None):
+    """Walk the resolved tree and emit (path, value) leaf records using
+    the property tree's path notation (arrays as name[i]).  When a
+    schema is supplied, leaves are coerced to their declared types."""
+    if isinstance(node, dict):
+        for key, child in sorted(node.items()):
+            flatten(child, path + '/' + key, records, sch)
+    elif isinstance(node, list):
+        for i, child in enumerate(node):
+            flatten(child, '%s[%d]' % (path, i), records, sch)
+    elif sch:
+        records.extend(sch.apply(path, node))
+    else:
+        records.append((path, node))
+
+def collect_prop_paths(node, paths):
+    """Gather every property path named by a 'prop' wiring entry
+    (component input/output/reference/enable and friends).  Values may
+    be a single path or a list of paths."""
+    if isinstance(node, dict):
+        for key, child in node.items():
+            if key == 'prop':
+                if isinstance(child, str):
+                    paths.add(child)
+                elif isinstance(child, list):
+                    paths.update(p for p in child if isinstance(p, str))
+            else:
+                collect_prop_paths(child, paths)
+    elif isinstance(node, list):
+        for child in node:
+            collect_prop_paths(child, paths)
+
+def write_blob(records, prop_paths, input_hash, out_path):
+    pool = bytearray()
+    offsets = {}
+    def intern(s):
+        data = s.encode('utf8') + b'\0'
+        if s not in offsets:
+            offsets[s] = len(pool)
+            pool.extend(data)
+        return offsets[s]
+    packed = []
+    for path, value in sorted(records):
+        path_off = intern(path)
+        if isinstance(value, bool):
+            packed.append(struct.pack('<IIq', path_off, TYPE_BOOL,
+                                      int(value)))
+        elif isinstance(value, int):
+            packed.append(struct.pack('<IIq', path_off, TYPE_INT, value))
+        elif isinstance(value, float):
+            packed.append(struct.pack('<IId', path_off, TYPE_DOUBLE,
+                                      value))
+        else:
+            val_off = intern(str(value))
+            packed.append(struct.pack('<IIII', path_off, TYPE_STRING,
+                                      val_off, len(str(value))))
+    prop_table = b''.join(struct.pack('<I', intern(p))
+                          for p in sorted(prop_paths))
+    header = MAGIC + struct.pack('<HHIIII', VERSION, 0, len(packed),
+                                 len(pool), len(prop_paths), 0) \
+                   + input_hash
+    with open(out_path, 'wb') as f:
+        f.write(header)
+        f.write(b''.join(packed))
+        f.write(prop_table)
+        f.write(bytes(pool))
+
+def hash_inputs(input_files):
+    h = hashlib.sha256()
+    for path, data in input_files:
+        h.update(data)
+    return h.digest()
+
+def read_blob_hash(path):
+    with open(path, 'rb') as f:
+        header = f.read(HEADER_LEN)
+    if len(header) < HEADER_LEN or header[0:4] != MAGIC:
+        return None
+    version = struct.unpack('<H', header[4:6])[0]
+    if version != VERSION:
+        return None
+    return header[24:56]
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='compile a main-*.json config into a binary blob')
+    parser.add_argument('main', help='path to main-*.json')
+    parser.add_argument('-o', '--output',
+                        help='blob output path (default: build/<name>.blob)')
+    parser.add_argument('--check', action='store_true',
+                        help='exit 0 if an up-to-date blob already exists')
+    parser.add_argument('--schema',
+                        help='typed schema (default: schema/types.json '
+                             'next to the main config)')
+    args = parser.parse_args()
+
+    tree, input_files = configtree.load_main(args.main)
+
+    schema_path = args.schema
+    if not schema_path:
+        schema_path = os.path.join(os.path.dirname(args.main),
+                                   'schema', 'types.json')
+        if not os.path.exists(schema_path):
+            schema_path = None
+    sch = None
+    if schema_path:
+        sch, schema_input = schema_mod.load(schema_path)
+        input_files = input_files + [schema_input]
+
+    input_hash = hash_inputs(input_files)
+
+    out_path = args.output
+    if not out_path:
+        name = os.path.splitext(os.path.basename(args.main))[0]
+        out_path = os.path.join('build', name + '.blob')
+
+    if args.check:
+        if os.path.exists(out_path) \
+           and read_blob_hash(out_path) == input_hash:
+            print('%s: up to date' % out_path)
+            return 0
+        print('%s: stale or missing' % out_path)
+        return 1
+
+    records = []
+    try:
+        flatten(tree, '', records, sch)
+    except schema_mod.SchemaError as e:
+        print('schema error: %s' % e)
+        return 1
+    prop_paths = set()
+    collect_prop_paths(tree, prop_paths)
+    os.makedirs(os.path.dirname(out_path) or '.', exist_ok=True)
+    write_blob(records, prop_paths, input_hash, out_path)
+    print('%s: %d files -> %d nodes, %d prop paths, %d bytes' %
+          (out_path, len(input_files), len(records), len(prop_paths),
+           os.path.getsize(out_path)))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+
+# config_validate.py - offline validator for vehicle configs.
+#
+# Loads a main-*.json, resolves all includes, type-checks every leaf
+# against config/schema/types.json, and cross-references every
+# property path named by the wiring (component input/output/reference/
+# enable 'prop' entries, mission switch inputs/outputs, gain schedule
+# props) against the subtrees the configured modules publish
+# (config/schema/published-paths.json) plus the paths written within
+# the config itself.  Wiring typos and moved includes are caught on
+# the bench in milliseconds instead of at runtime on the aircraft.
+#
+#     tools/config_validate.py config/main-skywalker.json
+#     tools/config_validate.py --all [config-dir]
+#
+# --stamp writes build/<name>.blob.valid next to an up-to-date compiled
+# blob so startup can skip re-validation of a blob this tool already
+# checked.
+
+import argparse
+import glob
+import json
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import configtree
+import schema as schema_mod
+import config_compile
+
+def collect_wiring(node, refs, writes):
+    """Gather referenced property paths (with a context string) and
+    paths written by the config itself."""
+    if isinstance(node, dict):
+        for key, child in node.items():
+            if key == 'prop':
+                paths = [child] if isinstance(child, str) else \
+                        [p for p in child if isinstance(p, str)]
+                for p in paths:
+                    refs.append((p, 'prop'))
+            elif key == 'output' and isinstance(child, dict) \
+                 and isinstance(child.get('prop'), str):
+                writes.add(child['prop'])
+                collect_wiring(child, refs, writes)
+            elif key == 'switch' and isinstance(child, list):
+                for sw in child:
+                    if isinstance(sw.get('input'), str):
+                        refs.append((sw['input'], 'switch input'))
+                    if isinstance(sw.get('output'), str):
+                        writes.add(sw['output'])
+            else:
+                collect_wiring(child, refs, writes)
+    elif isinstance(node, list):
+        for child in node:
+            collect_wiring(child, refs, writes)
+
+def load_published(path):
+    with open(path) as f:
+        table = json.loads(configtree.strip_comments(f.read()))
+    prefixes, exact = [], set()
+    for module, entries in table.items():
+        for entry in entries:
+            if entry.endswith('/'):
+                prefixes.append(entry)
+            else:
+                exact.add(entry)
+    return prefixes, exact
+
+def type_check(node, path, sch, errors):
+    if isinstance(node, dict):
+        for key, child in node.items():
+            type_check(child, path + '/' + key, sch, errors)
+    elif isinstance(node, list):
+        for i, child in enumerate(node):
+            type_check(child, '%s[%d]' % (path, i), sch, errors)
+    else:
+        try:
+            sch.apply(path, node)
+        except schema_mod.SchemaError as e:
+            errors.append(str(e))
+
+def validate(main, sch, schema_input, prefixes, exact, stamp):
+    name = os.path.basename(main)
+    errors = []
+
+    loader = configtree.ConfigLoader()
+    try:
+        tree, input_files = loader.load_main(main)
+    except OSError as e:
+        print('%s: INCLUDE error: %s' % (name, e))
+        return 1
+
+    type_check(tree, '', sch, errors)
+
+    refs, writes = [], set()
+    collect_wiring(tree, refs, writes)
+    for path, context in refs:
+        if path in writes or path in exact:
+            continue
+        if any(path.startswith(p) for p in prefixes):
+            continue
+        errors.append('%s path %s matches nothing any module publishes'
+                      % (context, path))
+
+    if errors:
+        for e in errors:
+            print('%s: %s' % (name, e))
+        return 1
+
+    print('%s: ok (%d files, %d wiring paths checked)'
+          % (name, len(input_files), len(refs)))
+    if stamp:
+        # the compiler folds the schema into the blob hash; match it
+        input_hash = config_compile.hash_inputs(
+            input_files + [schema_input])
+        blob = os.path.join('build',
+                            os.path.splitext(name)[0] + '.blob')
+        if config_compile.read_blob_hash(blob) == input_hash:
+            with open(blob + '.valid', 'w') as f:
+                f.write(input_hash.hex() + '\n')
+            print('%s: stamped %s.valid' % (name, blob))
+        else:
+            print('%s: no up-to-date blob to stamp' % name)
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='validate config wiring, types, and includes')
+    parser.add_argument('main', nargs='?',
+                        help='a main-*.json (or use --all)')
+    parser.add_argument('--all', metavar='DIR', nargs='?',
+                        const='config',
+                        help='validate every main-*.json in DIR')
+    parser.add_argument('--stamp', action='store_true',
+                        help='stamp an up-to-date compiled blob as '
+                             'validated')
+    args = parser.parse_args()
+
+    if not args.main and not args.all:
+        parser.error('give a main config or --all')
+    config_dir = args.all or os.path.dirname(args.main)
+
+    sch, schema_input = schema_mod.load(
+        os.path.join(config_dir, 'schema', 'types.json'))
+    prefixes, exact = load_published(
+        os.path.join(config_dir, 'schema', 'published-paths.json'))
+
+    mains = [args.main] if args.main else \
+        sorted(glob.glob(os.path.join(config_dir, 'main-*.json')))
+    status = 0
+    for m in mains:
+        status |= validate(m, sch, schema_input, prefixes, exact,
+                           args.stamp)
+    return status
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,95 @@
+# configtree.py - shared loader for the config tree.
+#
+# Loads a main-*.json and resolves its 'include' directives in a single
+# pass.  Every file is parsed and resolved exactly once per loader
+# instance and cached by real path, so fragments shared across vehicle
+# mains (comms/telnet.json, drivers/rcfmu.json, ...) are grafted into
+# each main from the cache instead of being re-read from disk.
+#
+# Overlay semantics (see docs/include-overlay.md): keys that appear
+# alongside an 'include' override the matching keys from the included
+# file, merged depth first.  Keys whose name starts with '#' are
+# disabled sections and are dropped.
+
+import json
+import os
+import re
+
+# the flight code's config loader accepts c++ style comments inside the
+# json files, so strip them before handing the text to the json parser.
+# comments only ever appear at the start of a line or after a value,
+# never inside a quoted string in this tree.
+comment_re = re.compile(r'^\s*//.*$|(?<=[,{\[\s])//.*$', re.MULTILINE)
+
+def strip_comments(text):
+    return comment_re.sub('', text)
+
+def overlay(base, over):
+    """Deep merge 'over' on top of 'base'; the overriding side wins.
+    Produces a new tree and never mutates either argument."""
+    result = dict(base)
+    for key, value in over.items():
+        if key in result and isinstance(result[key], dict) \
+           and isinstance(value, dict):
+            result[key] = overlay(result[key], value)
+        else:
+            result[key] = value
+    return result
+
+class ConfigLoader:
+    """Single-pass include resolver with a per-file parse cache.
+
+    Cached resolved subtrees are shared between mains; treat the
+    returned tree as read-only (the offline tools only ever walk it).
+    """
+
+    def __init__(self):
+        # realpath -> (resolved tree, transitive (path, bytes) list)
+        self.cache = {}
+
+    def load_main(self, path):
+        """Load and resolve a config file.  Returns (tree, input_files)
+        where input_files is the ordered list of (path, bytes) that went
+        into the tree, suitable for hashing."""
+        return self._load_resolved(path)
+
+    def _load_resolved(self, path):
+        key = os.path.realpath(path)
+        if key in self.cache:
+            return self.cache[key]
+        with open(path, 'rb') as f:
+            data = f.read()
+        tree = json.loads(strip_comments(data.decode('utf8')))
+        input_files = [(path, data)]
+        tree = self._resolve(tree, os.path.dirname(path), input_files)
+        self.cache[key] = (tree, input_files)
+        return tree, input_files
+
+    def _resolve(self, node, base_dir, input_files):
+        if isinstance(node, list):
+            return [self._resolve(child, base_dir, input_files)
+                    for child in node]
+        if not isinstance(node, dict):
+            return node
+        result = {}
+        if 'include' in node:
+            inc_path = os.path.join(base_dir, node['include'])
+            inc_tree, inc_files = self._load_resolved(inc_path)
+            for inc in inc_files:
+                if inc not in input_files:
+                    input_files.append(inc)
+            result.update(inc_tree)
+        for key, child in node.items():
+            if key == 'include' or key.startswith('#'):
+                continue
+            child = self._resolve(child, base_dir, input_files)
+            if key in result and isinstance(result[key], dict) \
+               and isinstance(child, dict):
+                result[key] = overlay(result[key], child)
+            else:
+                result[key] = child
+        return result
+
+def load_main(path):
+    """One-shot convenience wrapper around ConfigLoader."""
+    return ConfigLoader().load_main(path)
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+
+# mix_matrix.py - fold an actuator config's mixing stages and channel
+# gains into the single composed mixing matrix the runtime applies.
+#
+# The mixing section expresses output mixing as a stack of mode stages
+# (auto_coordination, flaperon, elevon, vtail, ...), each a separate
+# pass over the channel vector.  The loader now composes the enabled
+# stages, in listed order, with the per-channel gains into one 5x5
+# matrix at config time, so runtime mixing is a single matrix-vector
+# multiply; the composed matrix is published under
+# /actuators/mix_matrix/ in flight.  This tool performs the same
+# composition on the bench so the stack of mix entries can be verified
+# per airframe.
+#
+# Channel order (inputs and outputs): throttle, aileron, elevator,
+# rudder, flaps.  Stage models match the flight code:
+#
+#   auto_coordination: rudder   += gain1 * aileron
+#   throttle_trim:     elevator += gain1 * throttle
+#   flap_trim:         elevator += gain1 * flaps
+#   elevon:   ail' = g1*ail + g2*ele ; ele' = g1*ail - g2*ele
+#   flaperon: ail' = g1*ail + g2*flap; flap' = -g1*ail + g2*flap
+#   vtail:    ele' = g1*ele + g2*rud ; rud' = g1*ele - g2*rud
+#   diff_thrust: thr' = g1*thr + g2*rud
+#
+#     tools/mix_matrix.py config/actuators/Aura3-talon.json
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import configtree
+
+CHANNELS = ['throttle', 'aileron', 'elevator', 'rudder', 'flaps']
+THR, AIL, ELE, RUD, FLAP = range(5)
+
+def identity():
+    return [[1.0 if r == c else 0.0 for c in range(5)]
+            for r in range(5)]
+
+def matmul(a, b):
+    return [[sum(a[r][k] * b[k][c] for k in range(5))
+             for c in range(5)] for r in range(5)]
+
+def stage_matrix(mode, gain1, gain2):
+    m = identity()
+    if mode == 'auto_coordination':
+        m[RUD][AIL] = gain1
+    elif mode == 'throttle_trim':
+        m[ELE][THR] = gain1
+    elif mode == 'flap_trim':
+        m[ELE][FLAP] = gain1
+    elif mode == 'elevon':
+        m[AIL][AIL] = gain1; m[AIL][ELE] = gain2
+        m[ELE][AIL] = gain1; m[ELE][ELE] = -gain2
+    elif mode == 'flaperon':
+        m[AIL][AIL] = gain1; m[AIL][FLAP] = gain2
+        m[FLAP][AIL] = -gain1; m[FLAP][FLAP] = gain2
+    elif mode == 'vtail':
+        m[ELE][ELE] = gain1; m[ELE][RUD] = gain2
+        m[RUD][ELE] = gain1; m[RUD][RUD] = -gain2
+    elif mode == 'diff_thrust':
+        m[THR][THR] = gain1; m[THR][RUD] = gain2
+    else:
+        return None
+    return m
+
+def compose(tree):
+    """Returns (matrix, stages, warnings) for a resolved actuator
+    config."""
+    stages = []
+    warnings = []
+    m = identity()
+    for mix in tree.get('mixing', {}).get('mix', []):
+        if str(mix.get('enable', 'False')).lower() != 'true':
+            continue
+        mode = mix.get('mode', '?')
+        gain1 = float(mix.get('gain1', 1.0))
+        gain2 = float(mix.get('gain2', 1.0))
+        s = stage_matrix(mode, gain1, gain2)
+        if s is None:
+            warnings.append('unknown mix mode %r (skipped)' % mode)
+            continue
+        stages.append(mode)
+        m = matmul(s, m)
+    gains = [float(g) for g in
+             tree.get('gains', {}).get('channel', [])]
+    # channel gains are applied before the mix stages, so they fold in
+    # as column scaling: composed = S_n * ... * S_1 * G
+    for i, g in enumerate(gains[:5]):
+        for r in range(5):
+            m[r][i] *= g
+    return m, stages, warnings
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='print the composed actuator mixing matrix')
+    parser.add_argument('config', help='actuator json (or a main-*.json)')
+    args = parser.parse_args()
+
+    tree, _ = configtree.load_main(args.config)
+    if 'config' in tree:
+        tree = tree['config'].get('actuators', {}).get('actuator', {})
+    if 'mixing' not in tree:
+        print('%s: no mixing section found' % args.config)
+        return 1
+
+    m, stages, warnings = compose(tree)
+    for w in warnings:
+        print('warning: %s' % w)
+    print('%s: composed stages: %s'
+          % (args.config, ' -> '.join(stages) or '(none)'))
+    print('%-9s  %s' % ('output', '  '.join('%9s' % c for c in CHANNELS)))
+    for r in range(5):
+        print('%-9s  %s' % (CHANNELS[r],
+                            '  '.join('%9.4f' % v for v in m[r])))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
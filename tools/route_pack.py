@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+
+# route_pack.py - convert a json route (wpt array of relative
+# dist_m/heading_deg entries) into the streaming binary route format,
+# or dump a streaming route for inspection.
+#
+# The json wpt array is fine for the 2-10 point patterns flown by hand,
+# but generated survey routes run to thousands of waypoints and parsing
+# them as one json document spikes memory and load time on the fmu.
+# The streaming format uses fixed-size records so the runtime can mmap
+# the file and window-load around the active leg with prefetch; route
+# size then affects neither load time nor resident memory.
+#
+# File layout (little endian):
+#
+#   offset  size  field
+#        0     4  magic "RCRT"
+#        4     2  format version (currently 1)
+#        6     2  flags (reserved, 0)
+#        8     4  waypoint count
+#       12     4  reserved (0)
+#       16   16*n waypoint records
+#
+# Waypoint record (16 bytes): f32 dist_m, f32 heading_deg,
+# f32 alt_agl_ft, f32 speed_kt.  alt/speed are 0 when the waypoint
+# inherits the route defaults.
+#
+# A mission references a streaming route with "file" instead of
+# "include":
+#
+#     { "name": "route", "file": "../routes/survey-field7.route" }
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import configtree
+
+MAGIC = b"RCRT"
+VERSION = 1
+RECORD = struct.Struct('<ffff')
+
+def pack(json_path, out_path):
+    tree, _ = configtree.load_main(json_path)
+    wpts = tree.get('wpt', [])
+    with open(out_path, 'wb') as f:
+        f.write(MAGIC + struct.pack('<HHII', VERSION, 0, len(wpts), 0))
+        for wpt in wpts:
+            f.write(RECORD.pack(float(wpt.get('dist_m', 0)),
+                                float(wpt.get('heading_deg', 0)),
+                                float(wpt.get('alt_agl_ft', 0)),
+                                float(wpt.get('speed_kt', 0))))
+    print('%s: %d waypoints, %d bytes'
+          % (out_path, len(wpts), os.path.getsize(out_path)))
+
+def dump(path):
+    with open(path, 'rb') as f:
+        header = f.read(16)
+        if header[0:4] != MAGIC:
+            print('%s: not a streaming route' % path)
+            return 1
+        version, flags, count, _ = struct.unpack('<HHII', header[4:16])
+        if version != VERSION:
+            print('%s: unsupported version %d' % (path, version))
+            return 1
+        print('# %s: %d waypoints' % (path, count))
+        print('# dist_m heading_deg alt_agl_ft speed_kt')
+        for i in range(count):
+            print('%.1f %.1f %.1f %.1f'
+                  % RECORD.unpack(f.read(RECORD.size)))
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='pack a json route into the streaming route format')
+    parser.add_argument('route', help='route json, or .route with --dump')
+    parser.add_argument('-o', '--output',
+                        help='output path (default: <route>.route)')
+    parser.add_argument('--dump', action='store_true',
+                        help='print the contents of a streaming route')
+    args = parser.parse_args()
+    if args.dump:
+        return dump(args.route)
+    out_path = args.output
+    if not out_path:
+        out_path = os.path.splitext(args.route)[0] + '.route'
+    pack(args.route, out_path)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,86 @@
+# schema.py - typed schema support for the config tree.
+#
+# config/schema/types.json maps property path patterns to types so the
+# loader can convert quoted numeric strings ("cruise_kt": "20") into
+# native doubles/ints/bools at parse time.  Hot-path consumers then read
+# a plain value instead of paying a string conversion per access.
+#
+# Pattern syntax: array indices are written as [] and '*' matches within
+# a single path segment (fnmatch rules).  First matching pattern wins;
+# unlisted leaves keep their literal json type.
+
+import fnmatch
+import json
+import re
+
+index_re = re.compile(r'\[\d+\]')
+
+class SchemaError(Exception):
+    pass
+
+class Schema:
+    def __init__(self, patterns):
+        # list of (segment tuple, type string) in types.json file order;
+        # lookup() takes the first match
+        self.patterns = [(tuple(p.strip('/').split('/')), t)
+                         for p, t in patterns.items()]
+
+    def lookup(self, path):
+        norm = index_re.sub('[]', path).strip('/').split('/')
+        for segs, type_name in self.patterns:
+            if len(segs) == len(norm) and \
+               all(fnmatch.fnmatchcase(n, s)
+                   for n, s in zip(norm, segs)):
+                return type_name
+        return None
+
+    def apply(self, path, value):
+        """Coerce a leaf to its schema type.  Returns a list of
+        (path, typed value) records; vec3/mat4 leaves expand to
+        multiple double records."""
+        type_name = self.lookup(path)
+        if type_name is None or type_name in ('string', 'path'):
+            return [(path, value)]
+        try:
+            if type_name == 'float':
+                return [(path, float(value))]
+            if type_name == 'int':
+                return [(path, int(float(value)))]
+            if type_name == 'bool':
+                return [(path, parse_bool(value))]
+            if type_name.startswith('enum:'):
+                allowed = type_name[5:].split(',')
+                if value not in allowed:
+                    raise ValueError('not one of %s' % ','.join(allowed))
+                return [(path, value)]
+            if type_name == 'vec3':
+                return expand_tuple(path, value, 3)
+            if type_name == 'mat4':
+                return expand_tuple(path, value, 16)
+        except ValueError as e:
+            raise SchemaError('%s: %r: %s' % (path, value, e))
+        raise SchemaError('%s: unknown schema type %r' % (path, type_name))
+
+def parse_bool(value):
+    if isinstance(value, bool):
+        return value
+    if str(value).lower() in ('true', '1'):
+        return True
+    if str(value).lower() in ('false', '0'):
+        return False
+    raise ValueError('not a boolean')
+
+def expand_tuple(path, value, n):
+    parts = str(value).split()
+    if len(parts) != n:
+        raise ValueError('expected %d coefficients, got %d'
+                         % (n, len(parts)))
+    return [('%s[%d]' % (path, i), float(p))
+            for i, p in enumerate(parts)]
+
+def load(path):
+    import configtree
+    with open(path, 'rb') as f:
+        data = f.read()
+    patterns = json.loads(configtree.strip_comments(data.decode('utf8')))
+    return Schema(patterns), (path, data)